@@ -55,13 +55,18 @@ typedef struct World World;
 
 World* World_New(int gen_proc_rabbits, int gen_proc_foxes, int gen_food_foxes,
     int n_gen, int n_rows, int n_cols);
+World* World_Clone(World const* world);
 void World_Delete(World* world);
 int World_CoordsToIdx(World const* world, int x, int y);
 WorldObjectPos* World_GetObject(World const* world, int idx);
 void World_UpdateGrid(World* world);
+int32 World_CountObjects(World const* world, ObjectType obj_type);
 void World_Print(World const* world);
 void World_PrettyPrint(World const* world);
 int World_Compare(World const* left, World const* right);
+char const* World_ObjectName(ObjectType obj_type);
+uint32 World_ObjectState(WorldObject const* obj);
+int World_FindDifference(World const* left, World const* right, int* out_x, int* out_y);
 
 inline World* World_New(int gen_proc_rabbits, int gen_proc_foxes, int gen_food_foxes,
     int n_gen, int n_rows, int n_cols)
@@ -109,6 +114,16 @@ inline World* World_New(int gen_proc_rabbits, int gen_proc_foxes, int gen_food_f
     return world;
 }
 
+inline World* World_Clone(World const* world)
+{
+    World* clone = World_New(world->gen_proc_rabbits, world->gen_proc_foxes,
+        world->gen_food_foxes, world->n_gen, world->n_rows, world->n_cols);
+
+    size_t grid_size = (world->n_rows + 2) * (world->n_cols + 2) * sizeof(WorldObjectPos);
+    memcpy(clone->grid, world->grid, grid_size);
+    return clone;
+}
+
 inline void World_Delete(World* world)
 {
     // free the single malloc
@@ -117,8 +132,8 @@ inline void World_Delete(World* world)
 
 inline int World_CoordsToIdx(World const* world, int x, int y)
 {
-    // not a simple (x + world->n_row * y) because of extra borders
-    return (x + 1) * (world->n_rows + 2) + (y + 1);
+    // not a simple (x * world->n_cols + y) because of extra borders
+    return (x + 1) * (world->n_cols + 2) + (y + 1);
 }
 
 inline WorldObjectPos* World_GetObject(World const* world, int idx)
@@ -139,6 +154,23 @@ inline void World_UpdateGrid(World* world)
     }
 }
 
+inline int32 World_CountObjects(World const* world, ObjectType obj_type)
+{
+    int32 n_objs = 0;
+    for (int x = 0; x < world->n_rows; ++x)
+    {
+        for (int y = 0; y < world->n_cols; ++y)
+        {
+            int idx = World_CoordsToIdx(world, x, y);
+            WorldObjectPos const* obj = World_GetObject(world, idx);
+            if (obj->first.type == obj_type)
+                ++n_objs;
+        }
+    }
+
+    return n_objs;
+}
+
 inline void World_Print(World const* world)
 {
     int n_objs = 0;
@@ -168,13 +200,7 @@ inline void World_Print(World const* world)
             if (obj_type == OBJECT_TYPE_NONE)
                 continue;
 
-            const char* obj_name = "ROCK";
-            if (obj_type == OBJECT_TYPE_RABBIT)
-                obj_name = "RABBIT";
-            else if (obj_type == OBJECT_TYPE_FOX)
-                obj_name = "FOX";
-
-            printf("%s %d %d\n", obj_name, x, y);
+            printf("%s %d %d\n", World_ObjectName(obj_type), x, y);
         }
     }
 }
@@ -256,4 +282,74 @@ inline int World_Compare(World const* left, World const* right)
     return 0;
 }
 
+inline char const* World_ObjectName(ObjectType obj_type)
+{
+    switch (obj_type)
+    {
+        default:
+        case OBJECT_TYPE_NONE:
+            return "NONE";
+        case OBJECT_TYPE_ROCK:
+            return "ROCK";
+        case OBJECT_TYPE_RABBIT:
+            return "RABBIT";
+        case OBJECT_TYPE_FOX:
+            return "FOX";
+    }
+}
+
+inline uint32 World_ObjectState(WorldObject const* obj)
+{
+    //! empty cells only get their type reset, so any ages left behind
+    //! are garbage that never affects later generations - don't compare them
+    if (obj->type == OBJECT_TYPE_NONE)
+        return 0;
+
+    return (uint32)(obj->type & 0x7) |
+        ((uint32)obj->last_ate << 3) |
+        ((uint32)obj->gen_proc << 8);
+}
+
+inline int World_FindDifference(World const* left, World const* right,
+    int* out_x, int* out_y)
+{
+    // -1, -1 means the world configs differ, not a specific cell
+    *out_x = -1;
+    *out_y = -1;
+
+    if (left->gen_proc_rabbits != right->gen_proc_rabbits ||
+        left->gen_proc_foxes != right->gen_proc_foxes ||
+        left->gen_food_foxes != right->gen_food_foxes ||
+        left->n_gen != right->n_gen ||
+        left->n_rows != right->n_rows ||
+        left->n_cols != right->n_cols)
+        return 1;
+
+    for (int x = 0; x < left->n_rows; ++x)
+    {
+        //! rows are contiguous, so a raw memcmp filters out equal rows cheaply
+        //! it's stricter than the cell compare below (garbage ages in empty cells
+        //! count as different there), so it can never hide a divergence
+        int row_idx = World_CoordsToIdx(left, x, 0);
+        if (memcmp(World_GetObject(left, row_idx), World_GetObject(right, row_idx),
+                left->n_cols * sizeof(WorldObjectPos)) == 0)
+            continue;
+
+        for (int y = 0; y < left->n_cols; ++y)
+        {
+            int idx = World_CoordsToIdx(left, x, y);
+            WorldObjectPos const* left_obj = World_GetObject(left, idx);
+            WorldObjectPos const* right_obj = World_GetObject(right, idx);
+            if (World_ObjectState(&left_obj->first) != World_ObjectState(&right_obj->first))
+            {
+                *out_x = x;
+                *out_y = y;
+                return 1;
+            }
+        }
+    }
+
+    return 0;
+}
+
 #endif // __WORLD_H
@@ -6,8 +6,47 @@
 #include "Defines.h"
 #include "World.h"
 
+typedef struct Kernel Kernel;
+typedef void (*PhaseFn)(World* world, Kernel* kernel, uint64 gen);
+
+struct Kernel
+{
+    // moves all rabbits, then updates the grid
+    PhaseFn process_rabbits;
+    // moves all foxes, then updates the grid
+    PhaseFn process_foxes;
+
+    // population counts, only kept by kernels that elide phases
+    // for extinct species
+    int32 n_rabbits;
+    int32 n_foxes;
+};
+
+struct Engine
+{
+    // name used to select the engine from the command line
+    char const* name;
+    // picks the phase functions for a world, called once after it's loaded
+    Kernel (*select_kernel)(World* world);
+};
+
+typedef struct Engine Engine;
+
 void print_usage();
 World* read_world_from_file(const char* file_str);
+World* generate_random_world(uint64* rng_state);
+uint64 fuzz_rand(uint64* rng_state);
+Engine const* find_engine(char const* name);
+int simulate_world(World* world, Engine const* engine, Engine const* reference,
+    int verbose);
+int fuzz_worlds(uint32 n_worlds, uint64 seed, Engine const* engine,
+    Engine const* reference);
+Kernel select_kernel_reference(World* world);
+void process_rabbits_reference(World* world, Kernel* kernel, uint64 gen);
+void process_foxes_reference(World* world, Kernel* kernel, uint64 gen);
+Kernel select_kernel_elision(World* world);
+void process_rabbits_elision(World* world, Kernel* kernel, uint64 gen);
+void process_foxes_elision(World* world, Kernel* kernel, uint64 gen);
 WorldObjectPos* choose_move_rabbit(World const* world, uint32 gen,
     WorldObject const* obj, int x, int y);
 WorldObjectPos* choose_move_fox(World const* world, uint32 gen,
@@ -103,20 +142,462 @@ inline WorldObjectPos* choose_move_fox(World const* world, uint32 gen,
     return nullptr;
 }
 
+// engines selectable with --engine, the first one is the default
+static Engine const engines[] = {
+    { "elision", select_kernel_elision },
+    { "reference", select_kernel_reference },
+};
+
+Kernel select_kernel_reference(World* world)
+{
+    Kernel kernel = { process_rabbits_reference, process_foxes_reference, 0, 0 };
+    return kernel;
+}
+
+void process_rabbits_reference(World* world, Kernel* kernel, uint64 gen)
+{
+    for (int x = 0; x < world->n_rows; ++x)
+    {
+        for (int y = 0; y < world->n_cols; ++y)
+        {
+            int idx = World_CoordsToIdx(world, x, y);
+            WorldObjectPos* obj_pos = World_GetObject(world, idx);
+            WorldObject* obj = &(obj_pos->first);
+            if (obj->type != OBJECT_TYPE_RABBIT)
+                continue;
+
+            ++obj->gen_proc;
+
+            WorldObjectPos* local_obj_pos = choose_move_rabbit(world, gen,
+                obj, x, y);
+            if (local_obj_pos)
+            {
+                int const can_proc = obj->gen_proc > world->gen_proc_rabbits;
+
+                // reset proc age since we were able to move
+                if (can_proc)
+                    obj->gen_proc = 0;
+
+                // move obj to loc_idx
+                // conflict rules say the one with the older procreation age stays
+                WorldObject* local_obj = &(local_obj_pos->second);
+                if (local_obj->type == OBJECT_TYPE_RABBIT)
+                {
+                    if (obj->gen_proc > local_obj->gen_proc)
+                        (*local_obj) = (*obj);
+                }
+                else
+                    (*local_obj) = (*obj);
+
+                // procreation, leave rabbit in place
+                if (can_proc)
+                    obj_pos->second = (*obj);
+                else
+                    obj_pos->second.type = OBJECT_TYPE_NONE;
+
+                continue;
+            }
+
+            // failed to move, stay in same place
+            obj_pos->second = (*obj);
+        }
+    }
+
+    World_UpdateGrid(world);
+}
+
+void process_foxes_reference(World* world, Kernel* kernel, uint64 gen)
+{
+    for (int x = 0; x < world->n_rows; ++x)
+    {
+        for (int y = 0; y < world->n_cols; ++y)
+        {
+            int idx = World_CoordsToIdx(world, x, y);
+            WorldObjectPos* obj_pos = World_GetObject(world, idx);
+            WorldObject* obj = &(obj_pos->first);
+            if (obj->type != OBJECT_TYPE_FOX)
+                continue;
+
+            ++obj->gen_proc;
+            ++obj->last_ate;
+
+            // search for a rabbit or empty place
+            WorldObjectPos* local_obj_pos = choose_move_fox(world, gen,
+                obj, x, y);
+            if (local_obj_pos)
+            {
+                int const can_proc = obj->gen_proc > world->gen_proc_foxes;
+                // reset proc age since we were able to move
+                if (can_proc)
+                    obj->gen_proc = 0;
+
+                int is_target_rabbit = local_obj_pos->first.type == OBJECT_TYPE_RABBIT;
+                if (is_target_rabbit)
+                    obj->last_ate = 0;
+                // no rabbit found, die if too much time passed since last gen
+                else if (obj->last_ate >= world->gen_food_foxes)
+                {
+                    obj_pos->second.type = OBJECT_TYPE_NONE; // death
+                    continue;
+                }
+
+                // move fox to location
+                WorldObject* local_obj = &(local_obj_pos->second);
+                // overriding another fox, keep the one with older procreation age
+                // or if gen_proc is equal, the least hungry one
+                if (!is_target_rabbit && local_obj->type == OBJECT_TYPE_FOX)
+                {
+                    if (obj->gen_proc == local_obj->gen_proc &&
+                        obj->last_ate < local_obj->last_ate)
+                        (*local_obj) = (*obj);
+                    else if (obj->gen_proc > local_obj->gen_proc)
+                        (*local_obj) = (*obj);
+                }
+                else
+                    (*local_obj) = (*obj);
+
+                // procreation, leave fox in place
+                // it doesn't inherit father's last_ate
+                if (can_proc)
+                {
+                    obj_pos->second = (*obj);
+                    obj_pos->second.last_ate = 0;
+                }
+                else
+                    obj_pos->second.type = OBJECT_TYPE_NONE;
+
+                continue; // that's all folks
+            }
+
+            // no rabbit found, die if too much time passed since last gen
+            if (obj->last_ate >= world->gen_food_foxes)
+            {
+                obj_pos->second.type = OBJECT_TYPE_NONE; // death
+                continue;
+            }
+
+            // failed to move, stay in same place
+            obj_pos->second = (*obj);
+        }
+    }
+
+    World_UpdateGrid(world);
+}
+
+//! elision engine kernels
+//! the world configs are read into locals once per phase instead of through
+//! world on every animal (uint8 stores to the grid may alias world and kernel,
+//! so the compiler can't hoist them - the population counts are kept in locals
+//! for the same reason)
+//! a phase and its grid update are skipped once its species is extinct
+
+void process_rabbits_elision(World* world, Kernel* kernel, uint64 gen)
+{
+    // no rabbit can ever appear again, nothing to move or update
+    if (kernel->n_rabbits == 0)
+        return;
+
+    int const n_rows = world->n_rows;
+    int const n_cols = world->n_cols;
+    int32 const gen_proc_rabbits = world->gen_proc_rabbits;
+    int32 n_rabbits = kernel->n_rabbits;
+    for (int x = 0; x < n_rows; ++x)
+    {
+        for (int y = 0; y < n_cols; ++y)
+        {
+            int idx = World_CoordsToIdx(world, x, y);
+            WorldObjectPos* obj_pos = World_GetObject(world, idx);
+            WorldObject* obj = &(obj_pos->first);
+            if (obj->type != OBJECT_TYPE_RABBIT)
+                continue;
+
+            ++obj->gen_proc;
+
+            WorldObjectPos* local_obj_pos = choose_move_rabbit(world, gen,
+                obj, x, y);
+            if (local_obj_pos)
+            {
+                int const can_proc = obj->gen_proc > gen_proc_rabbits;
+
+                // reset proc age since we were able to move
+                if (can_proc)
+                {
+                    obj->gen_proc = 0;
+                    ++n_rabbits;
+                }
+
+                // move obj to loc_idx
+                // conflict rules say the one with the older procreation age stays
+                WorldObject* local_obj = &(local_obj_pos->second);
+                if (local_obj->type == OBJECT_TYPE_RABBIT)
+                {
+                    // only one of the two rabbits survives
+                    --n_rabbits;
+                    if (obj->gen_proc > local_obj->gen_proc)
+                        (*local_obj) = (*obj);
+                }
+                else
+                    (*local_obj) = (*obj);
+
+                // procreation, leave rabbit in place
+                if (can_proc)
+                    obj_pos->second = (*obj);
+                else
+                    obj_pos->second.type = OBJECT_TYPE_NONE;
+
+                continue;
+            }
+
+            // failed to move, stay in same place
+            obj_pos->second = (*obj);
+        }
+    }
+
+    kernel->n_rabbits = n_rabbits;
+    World_UpdateGrid(world);
+}
+
+void process_foxes_elision(World* world, Kernel* kernel, uint64 gen)
+{
+    // no fox can ever appear again, nothing to move or update
+    if (kernel->n_foxes == 0)
+        return;
+
+    int const n_rows = world->n_rows;
+    int const n_cols = world->n_cols;
+    int32 const gen_proc_foxes = world->gen_proc_foxes;
+    int32 const gen_food_foxes = world->gen_food_foxes;
+    int32 n_rabbits = kernel->n_rabbits;
+    int32 n_foxes = kernel->n_foxes;
+    for (int x = 0; x < n_rows; ++x)
+    {
+        for (int y = 0; y < n_cols; ++y)
+        {
+            int idx = World_CoordsToIdx(world, x, y);
+            WorldObjectPos* obj_pos = World_GetObject(world, idx);
+            WorldObject* obj = &(obj_pos->first);
+            if (obj->type != OBJECT_TYPE_FOX)
+                continue;
+
+            ++obj->gen_proc;
+            ++obj->last_ate;
+
+            // search for a rabbit or empty place
+            WorldObjectPos* local_obj_pos = choose_move_fox(world, gen,
+                obj, x, y);
+            if (local_obj_pos)
+            {
+                int const can_proc = obj->gen_proc > gen_proc_foxes;
+                // reset proc age since we were able to move
+                if (can_proc)
+                    obj->gen_proc = 0;
+
+                int is_target_rabbit = local_obj_pos->first.type == OBJECT_TYPE_RABBIT;
+                if (is_target_rabbit)
+                    obj->last_ate = 0;
+                // no rabbit found, die if too much time passed since last gen
+                else if (obj->last_ate >= gen_food_foxes)
+                {
+                    obj_pos->second.type = OBJECT_TYPE_NONE; // death
+                    --n_foxes;
+                    continue;
+                }
+
+                // move fox to location
+                WorldObject* local_obj = &(local_obj_pos->second);
+                // another fox got there first, only one of the two survives
+                // (this also covers two foxes eating the same rabbit)
+                if (local_obj->type == OBJECT_TYPE_FOX)
+                    --n_foxes;
+                else if (is_target_rabbit)
+                    --n_rabbits;
+
+                // overriding another fox, keep the one with older procreation age
+                // or if gen_proc is equal, the least hungry one
+                if (!is_target_rabbit && local_obj->type == OBJECT_TYPE_FOX)
+                {
+                    if (obj->gen_proc == local_obj->gen_proc &&
+                        obj->last_ate < local_obj->last_ate)
+                        (*local_obj) = (*obj);
+                    else if (obj->gen_proc > local_obj->gen_proc)
+                        (*local_obj) = (*obj);
+                }
+                else
+                    (*local_obj) = (*obj);
+
+                // procreation, leave fox in place
+                // it doesn't inherit father's last_ate
+                if (can_proc)
+                {
+                    obj_pos->second = (*obj);
+                    obj_pos->second.last_ate = 0;
+                    ++n_foxes;
+                }
+                else
+                    obj_pos->second.type = OBJECT_TYPE_NONE;
+
+                continue; // that's all folks
+            }
+
+            // no rabbit found, die if too much time passed since last gen
+            if (obj->last_ate >= gen_food_foxes)
+            {
+                obj_pos->second.type = OBJECT_TYPE_NONE; // death
+                --n_foxes;
+                continue;
+            }
+
+            // failed to move, stay in same place
+            obj_pos->second = (*obj);
+        }
+    }
+
+    kernel->n_rabbits = n_rabbits;
+    kernel->n_foxes = n_foxes;
+    World_UpdateGrid(world);
+}
+
+Kernel select_kernel_elision(World* world)
+{
+    Kernel kernel = { process_rabbits_elision, process_foxes_elision, 0, 0 };
+
+    // phase elision relies on the population counts, the kernels keep
+    // them up to date from here on as animals are born and die
+    kernel.n_rabbits = World_CountObjects(world, OBJECT_TYPE_RABBIT);
+    kernel.n_foxes = World_CountObjects(world, OBJECT_TYPE_FOX);
+    return kernel;
+}
+
+Engine const* find_engine(char const* name)
+{
+    for (size_t i = 0; i < sizeof(engines) / sizeof(engines[0]); ++i)
+        if (strcmp(engines[i].name, name) == 0)
+            return &engines[i];
+
+    return nullptr;
+}
+
 void print_usage()
 {
     printf("Usage: ./ecosystem $infile [options]\n");
+    printf("       ./ecosystem --fuzz n_worlds [options]\n");
     printf("Options:\n");
     printf("'--test test_file' uses world in test_file to compare with output world, exit error 1 if not equal\n");
+    printf("'--engine name' selects the generation engine, default '%s'\n", engines[0].name);
+    printf("'--verify-against name' steps engine 'name' in lockstep, exit error 1 on the first divergence\n");
+    printf("'--fuzz n_worlds' verifies against random worlds instead of $infile, uses 'reference' unless --verify-against is given\n");
+    printf("'--seed seed' random seed for --fuzz\n");
     printf("'--verbose' prints each world generation\n");
     printf("'--no-output' silences default output, don't use with --verbose\n");
     printf("'--help' prints this usage message\n");
 }
 
+int simulate_world(World* world, Engine const* engine, Engine const* reference,
+    int verbose)
+{
+    //! the reference world is stepped next to the engine's world
+    //! and both are compared after every generation
+    World* ref_world = reference ? World_Clone(world) : nullptr;
+    int diverged = 0;
+
+    Kernel kernel = engine->select_kernel(world);
+    Kernel ref_kernel = { nullptr, nullptr, 0, 0 };
+    if (ref_world)
+        ref_kernel = reference->select_kernel(ref_world);
+
+    if (verbose)
+    {
+        printf("Generation 0\n");
+        World_PrettyPrint(world);
+    }
+
+    uint64 const n_gen = world->n_gen;
+    for (uint64 gen = 0; gen < n_gen; ++gen)
+    {
+        kernel.process_rabbits(world, &kernel, gen);
+        kernel.process_foxes(world, &kernel, gen);
+        --world->n_gen;
+
+        if (ref_world)
+        {
+            ref_kernel.process_rabbits(ref_world, &ref_kernel, gen);
+            ref_kernel.process_foxes(ref_world, &ref_kernel, gen);
+            --ref_world->n_gen;
+
+            int x;
+            int y;
+            if (World_FindDifference(ref_world, world, &x, &y))
+            {
+                printf("Engine '%s' diverged from '%s' at generation %lu",
+                    engine->name, reference->name, gen + 1);
+                if (x < 0)
+                    printf(", world configs differ\n");
+                else
+                {
+                    int idx = World_CoordsToIdx(world, x, y);
+                    WorldObject const* ref_obj = &World_GetObject(ref_world, idx)->first;
+                    WorldObject const* obj = &World_GetObject(world, idx)->first;
+                    printf(", cell %d %d: expected %s gen_proc %d last_ate %d, got %s gen_proc %d last_ate %d\n",
+                        x, y,
+                        World_ObjectName(ref_obj->type), ref_obj->gen_proc, ref_obj->last_ate,
+                        World_ObjectName(obj->type), obj->gen_proc, obj->last_ate);
+                }
+
+                diverged = 1;
+                break;
+            }
+        }
+
+        if (verbose)
+        {
+            printf("\nGeneration %lu\n", gen + 1);
+            World_PrettyPrint(world);
+        }
+    }
+
+    if (ref_world)
+        World_Delete(ref_world);
+
+    return diverged;
+}
+
+int fuzz_worlds(uint32 n_worlds, uint64 seed, Engine const* engine,
+    Engine const* reference)
+{
+    uint64 rng_state = seed;
+    for (uint32 i = 0; i < n_worlds; ++i)
+    {
+        World* world = generate_random_world(&rng_state);
+        World* initial_world = World_Clone(world);
+
+        int diverged = simulate_world(world, engine, reference, 0);
+        if (diverged)
+        {
+            // dumped in input file format, can be fed back as $infile
+            printf("Failed fuzz world %u (seed %lu), initial world:\n", i, seed);
+            World_Print(initial_world);
+        }
+
+        World_Delete(initial_world);
+        World_Delete(world);
+
+        if (diverged)
+            return 1;
+    }
+
+    printf("Passed fuzzing %u worlds for engine '%s' against '%s'\n",
+        n_worlds, engine->name, reference->name);
+    return 0;
+}
+
 int main(int argc, char** argv)
 {
-    const char* input_world_file = argc > 1 ? argv[1] : NULL;
+    const char* input_world_file = argc > 1 && argv[1][0] != '-' ? argv[1] : NULL;
     const char* output_test_file = NULL;
+    Engine const* engine = &engines[0];
+    Engine const* reference = NULL;
+    uint32 n_fuzz_worlds = 0;
+    uint64 fuzz_seed = 1;
     int verbose = 0;
     int no_output = 0;
 
@@ -136,6 +617,53 @@ int main(int argc, char** argv)
             no_output = 1; // no normal output with test case, only passed/failed msg
             output_test_file = argv[i];
         }
+        else if (strcmp(arg, "--engine") == 0 ||
+            strcmp(arg, "--verify-against") == 0)
+        {
+            ++i;
+            if (i >= argc)
+            {
+                LOG_ERROR("%s option: missing name arg", arg);
+                return 1;
+            }
+
+            Engine const* selected = find_engine(argv[i]);
+            if (!selected)
+            {
+                LOG_ERROR("%s option: unknown engine '%s'", arg, argv[i]);
+                return 1;
+            }
+
+            if (strcmp(arg, "--engine") == 0)
+                engine = selected;
+            else
+            {
+                no_output = 1; // same as --test, only passed/failed msg
+                reference = selected;
+            }
+        }
+        else if (strcmp(arg, "--fuzz") == 0)
+        {
+            ++i;
+            if (i >= argc)
+            {
+                LOG_ERROR("--fuzz option: missing n_worlds arg");
+                return 1;
+            }
+
+            n_fuzz_worlds = strtoul(argv[i], NULL, 10);
+        }
+        else if (strcmp(arg, "--seed") == 0)
+        {
+            ++i;
+            if (i >= argc)
+            {
+                LOG_ERROR("--seed option: missing seed arg");
+                return 1;
+            }
+
+            fuzz_seed = strtoull(argv[i], NULL, 10);
+        }
         else if (strcmp(arg, "--verbose") == 0)
             verbose = 1;
         else if (strcmp(arg, "--no-output") == 0)
@@ -147,6 +675,14 @@ int main(int argc, char** argv)
         }
     }
 
+    if (n_fuzz_worlds > 0)
+    {
+        if (!reference)
+            reference = find_engine("reference");
+
+        return fuzz_worlds(n_fuzz_worlds, fuzz_seed, engine, reference);
+    }
+
     if (input_world_file == NULL)
     {
         print_usage();
@@ -160,156 +696,15 @@ int main(int argc, char** argv)
         return 1;
     }
 
-    if (verbose)
-    {
-        printf("Generation 0\n");
-        World_PrettyPrint(world);
-    }
-
-    uint64 const n_gen = world->n_gen;
-    for (uint64 gen = 0; gen < n_gen; ++gen)
-    {
-        // process rabbits
-        for (int x = 0; x < world->n_rows; ++x)
-        {
-            for (int y = 0; y < world->n_rows; ++y)
-            {
-                int idx = World_CoordsToIdx(world, x, y);
-                WorldObjectPos* obj_pos = World_GetObject(world, idx);
-                WorldObject* obj = &(obj_pos->first);
-                if (obj->type != OBJECT_TYPE_RABBIT)
-                    continue;
-
-                ++obj->gen_proc;
-
-                WorldObjectPos* local_obj_pos = choose_move_rabbit(world, gen,
-                    obj, x, y);
-                if (local_obj_pos)
-                {
-                    int const can_proc = obj->gen_proc > world->gen_proc_rabbits;
-
-                    // reset proc age since we were able to move
-                    if (can_proc)
-                        obj->gen_proc = 0;
-
-                    // move obj to loc_idx
-                    // conflict rules say the one with the older procreation age stays
-                    WorldObject* local_obj = &(local_obj_pos->second);
-                    if (local_obj->type == OBJECT_TYPE_RABBIT)
-                    {
-                        if (obj->gen_proc > local_obj->gen_proc)
-                            (*local_obj) = (*obj);
-                    }
-                    else
-                        (*local_obj) = (*obj);
-
-                    // procreation, leave rabbit in place
-                    if (can_proc)
-                        obj_pos->second = (*obj);
-                    else
-                        obj_pos->second.type = OBJECT_TYPE_NONE;
-
-                    continue;
-                }
-
-                // failed to move, stay in same place
-                obj_pos->second = (*obj);
-            }
-        }
-
-        World_UpdateGrid(world);
-
-        // process foxes
-        for (int x = 0; x < world->n_rows; ++x)
-        {
-            for (int y = 0; y < world->n_cols; ++y)
-            {
-                int idx = World_CoordsToIdx(world, x, y);
-                WorldObjectPos* obj_pos = World_GetObject(world, idx);
-                WorldObject* obj = &(obj_pos->first);
-                if (obj->type != OBJECT_TYPE_FOX)
-                    continue;
-
-                ++obj->gen_proc;
-                ++obj->last_ate;
-
-                // search for a rabbit or empty place
-                WorldObjectPos* local_obj_pos = choose_move_fox(world, gen,
-                    obj, x, y);
-                if (local_obj_pos)
-                {
-                    int const can_proc = obj->gen_proc > world->gen_proc_foxes;
-                    // reset proc age since we were able to move
-                    if (can_proc)
-                        obj->gen_proc = 0;
-
-                    int is_target_rabbit = local_obj_pos->first.type == OBJECT_TYPE_RABBIT;
-                    if (is_target_rabbit)
-                        obj->last_ate = 0;
-                    // no rabbit found, die if too much time passed since last gen
-                    else if (obj->last_ate >= world->gen_food_foxes)
-                    {
-                        obj_pos->second.type = OBJECT_TYPE_NONE; // death
-                        continue;
-                    }
-
-                    // move fox to location
-                    WorldObject* local_obj = &(local_obj_pos->second);
-                    // overriding another fox, keep the one with older procreation age
-                    // or if gen_proc is equal, the least hungry one
-                    if (!is_target_rabbit && local_obj->type == OBJECT_TYPE_FOX)
-                    {
-                        if (obj->gen_proc == local_obj->gen_proc &&
-                            obj->last_ate < local_obj->last_ate)
-                            (*local_obj) = (*obj);
-                        else if (obj->gen_proc > local_obj->gen_proc)
-                            (*local_obj) = (*obj);
-                    }
-                    else
-                        (*local_obj) = (*obj);
-
-                    // procreation, leave fox in place
-                    // it doesn't inherit father's last_ate
-                    if (can_proc)
-                    {
-                        obj_pos->second = (*obj);
-                        obj_pos->second.last_ate = 0;
-                    }
-                    else
-                        obj_pos->second.type = OBJECT_TYPE_NONE;
-
-                    continue; // that's all folks
-                }
-
-                // no rabbit found, die if too much time passed since last gen
-                if (obj->last_ate >= world->gen_food_foxes)
-                {
-                    obj_pos->second.type = OBJECT_TYPE_NONE; // death
-                    continue;
-                }
-
-                // failed to move, stay in same place
-                obj_pos->second = (*obj);
-            }
-        }
-
-        World_UpdateGrid(world);
-
-        --world->n_gen;
-
-        if (verbose)
-        {
-            printf("\nGeneration %lu\n", gen + 1);
-            World_PrettyPrint(world);
-        }
-    }
+    int exit_code = simulate_world(world, engine, reference, verbose);
+    if (reference && exit_code == 0)
+        printf("Passed verification of engine '%s' against '%s' for world size %dx%d\n",
+            engine->name, reference->name, world->n_rows, world->n_cols);
 
     if (no_output == 0)
         World_Print(world);
 
-    int exit_code = 0;
-
-    if (output_test_file)
+    if (output_test_file && exit_code == 0)
     {
         World* test_world = read_world_from_file(output_test_file);
         if (!test_world)
@@ -406,3 +801,77 @@ World* read_world_from_file(const char* file_str)
     fclose(file);
     return world;
 }
+
+// (gen_proc_rabbits, gen_proc_foxes, gen_food_foxes) of the shipped tests/input*
+// worlds, fuzzed on purpose so the configs that ship always get coverage
+static int const fuzz_configs[][3] = {
+    { 2, 4, 3 },
+    { 2, 9, 6 },
+    { 3, 9, 6 },
+    { 3, 20, 10 },
+};
+
+uint64 fuzz_rand(uint64* rng_state)
+{
+    // xorshift64*, deterministic so a failing --seed can be replayed
+    uint64 x = *rng_state;
+    x ^= x >> 12;
+    x ^= x << 25;
+    x ^= x >> 27;
+    *rng_state = x;
+    return x * 0x2545F4914F6CDD1DULL;
+}
+
+World* generate_random_world(uint64* rng_state)
+{
+    // xorshift state must never be 0
+    if (*rng_state == 0)
+        *rng_state = 1;
+
+    int const n_rows = 1 + fuzz_rand(rng_state) % 32;
+    int const n_cols = 1 + fuzz_rand(rng_state) % 32;
+    int gen_proc_rabbits = 1 + fuzz_rand(rng_state) % 10;
+    int gen_proc_foxes = 1 + fuzz_rand(rng_state) % 10;
+    int gen_food_foxes = 1 + fuzz_rand(rng_state) % 10;
+    int const n_gen = fuzz_rand(rng_state) % 64;
+
+    // half of the worlds use one of fuzz_configs
+    if (fuzz_rand(rng_state) % 2)
+    {
+        int const* config = fuzz_configs[fuzz_rand(rng_state) %
+            (sizeof(fuzz_configs) / sizeof(fuzz_configs[0]))];
+        gen_proc_rabbits = config[0];
+        gen_proc_foxes = config[1];
+        gen_food_foxes = config[2];
+    }
+
+    World* world = World_New(gen_proc_rabbits, gen_proc_foxes, gen_food_foxes,
+        n_gen, n_rows, n_cols);
+
+    // percentages of cells filled with each object type
+    uint32 const rock_pct = fuzz_rand(rng_state) % 20;
+    uint32 const rabbit_pct = fuzz_rand(rng_state) % 40;
+    uint32 const fox_pct = fuzz_rand(rng_state) % 30;
+
+    for (int x = 0; x < n_rows; ++x)
+    {
+        for (int y = 0; y < n_cols; ++y)
+        {
+            uint32 const roll = fuzz_rand(rng_state) % 100;
+            ObjectType obj_type = OBJECT_TYPE_NONE;
+            if (roll < rock_pct)
+                obj_type = OBJECT_TYPE_ROCK;
+            else if (roll < rock_pct + rabbit_pct)
+                obj_type = OBJECT_TYPE_RABBIT;
+            else if (roll < rock_pct + rabbit_pct + fox_pct)
+                obj_type = OBJECT_TYPE_FOX;
+
+            int idx = World_CoordsToIdx(world, x, y);
+            WorldObjectPos* obj = World_GetObject(world, idx);
+            obj->first.type = obj_type;
+            obj->second.type = obj_type;
+        }
+    }
+
+    return world;
+}
@@ -13,3 +13,7 @@ gcc -std=gnu11 -Wall -ggdb -O3 -mtune=native -march=native \
 ./../build/ecosystem input100x100_unbal02 --no-output --test output100x100_unbal02
 ./../build/ecosystem input200x200 --no-output --test output200x200
 
+# engine differential checks, stepped in lockstep with the reference engine
+./../build/ecosystem input100x100_unbal01 --engine elision --verify-against reference
+./../build/ecosystem input200x200 --engine elision --verify-against reference
+./../build/ecosystem --fuzz 1000 --seed 1 --engine elision --verify-against reference